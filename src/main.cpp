@@ -22,9 +22,12 @@ v1.3 - Upgraded library (manually) to IotWebConf 3.0.0pre2 (this won't work from
        uncommented CONFIG_PIN D1 to allow reset of password using a wire instead of flashing 
 v1.4 - Added new parameter to select a specific topic number for single display mode.
 v1.5 - Updated to IoTWebConf library 3.1.0 and added WHITE light option
+v1.6 - Added 'Rollup Last Topic #' parameter. In single status mode the whole ring shows the worst status of topic
+       'Single Topic #' up to 'Rollup Last Topic #' (e.g. red if any pipeline is red, else yellow, else green).
+       Counters per status are updated on each MQTT message, so the rollup does not rescan all leds.
 */
 
-#define VERSIONNUMBER "v1.5 - 25-06-2021"
+#define VERSIONNUMBER "v1.6 - 19-10-2026"
 
 #include <ESP8266WiFi.h>        //https://github.com/esp8266/Arduino
 #include <DNSServer.h>
@@ -53,7 +56,7 @@ const char wifiInitialApPassword[] = "password";
 #define STRING_LEN 128
 #define NUMBER_LEN 32
 // -- Configuration specific key. The value should be modified if config structure was changed.
-#define CONFIG_VERSION "npx10"
+#define CONFIG_VERSION "npx11"
 
 // -- When CONFIG_PIN is pulled to ground on startup, the Thing will use the initial
 //      password to buld an AP. (E.g. in case of lost password)
@@ -71,6 +74,8 @@ bool formValidator(iotwebconf::WebRequestWrapper* webRequestWrapper);
 void handleRoot();
 void showLedOffset();
 void mqttCallback(char* topic, byte* payload, unsigned int length);
+void initRollup();
+void updateRollup(int ledId, int oldState, int newState);
 
 void colorWipe(uint32_t c, uint8_t wait);
 void theaterChase(uint32_t c, uint8_t wait);
@@ -95,6 +100,7 @@ char ledOffsetValue[NUMBER_LEN];
 char ledBrightnessValue[NUMBER_LEN];
 char singleStatusValue[STRING_LEN];
 char singleTopicValue[NUMBER_LEN];
+char rollupLastValue[NUMBER_LEN];
 
 
 char mqttClientId[STRING_LEN]; //automatically created. not via config!
@@ -107,6 +113,8 @@ IotWebConfTextParameter mqttTopicParam = IotWebConfTextParameter("MQTT Topic", "
 IotWebConfNumberParameter ledOffsetParam = IotWebConfNumberParameter("Led Offset", "ledOffset", ledOffsetValue, NUMBER_LEN, "0");
 IotWebConfCheckboxParameter singleStatusParam = IotWebConfCheckboxParameter("Single Status", "singleStatus", singleStatusValue, STRING_LEN,  false);
 IotWebConfNumberParameter singleTopicParam = IotWebConfNumberParameter("Single Topic # ", "singleTopic", singleTopicValue, NUMBER_LEN, "1");
+//Rollup Last Topic: 0 (or not higher than Single Topic) disables the rollup. Otherwise single status shows the worst status of Single Topic up to this topic.
+IotWebConfNumberParameter rollupLastParam = IotWebConfNumberParameter("Rollup Last Topic # ", "rollupLast", rollupLastValue, NUMBER_LEN, "0", "0..12", "min='0' max='12' step='1'");
 
 //LedBrightness: 255 is the max brightness. It will draw to much current if you turn on all leds on white color (12 leds x 20 milliAmps x 3 colors (to make white) = 720 mA. Wemos can handle 500 mA)
 //White means all leds Red/Green/Blue on so 3 x 20 mA per pixel. Just to be sure limited the Max setting to 200 instead of 255. No exact science though.
@@ -155,6 +163,21 @@ From MQTT I want to drive Led 1 to 12. Not led 0 to 11.
 */
 int ledStateArr[NUMBEROFLEDS+1]; //Store state of each led (where Led 1 = ledStateArr[1] and not ledStateArr[0])
 
+/*
+Worst-of rollup for single status mode.
+rollupCount[state] holds how many topics between rollupFirst and rollupLast currently have that state (0 up to 14).
+mqttCallback() only moves one topic from its old state counter to its new state counter, and then walks the
+fixed severityOrder[] list to find the worst state that is in use. So the cost per message does not depend on
+the number of leds. rollupState holds the result and is used by loop() to drive colorWipe/theaterChase.
+*/
+#define NUMBEROFSTATES 15 //off (0) up to whiteblink (14)
+const int severityOrder[NUMBEROFSTATES] = {4, 3, 12, 11, 6, 5, 8, 7, 10, 9, 14, 13, 2, 1, 0}; //red, orange, yellow, purple, blue, white, green, off (blink before steady)
+int rollupCount[NUMBEROFSTATES];
+int rollupFirst = 0;      //first topic of the rollup range (Single Topic #)
+int rollupLast = 0;       //last topic of the rollup range (Rollup Last Topic #)
+bool rollupEnabled = false;
+int rollupState = 0;      //worst state within the rollup range
+
 
 //***************************** SETUP ***************************************************
 void setup() {
@@ -174,6 +197,7 @@ void setup() {
   iotWebConf.addSystemParameter(&ledBrightnessParam);
   iotWebConf.addSystemParameter(&singleStatusParam);
   iotWebConf.addSystemParameter(&singleTopicParam);
+  iotWebConf.addSystemParameter(&rollupLastParam);
 
   iotWebConf.setConfigSavedCallback(&configSaved);
   iotWebConf.setFormValidator(&formValidator);
@@ -196,7 +220,10 @@ void setup() {
     ledBrightnessValue[0] = '\0';
     singleStatusValue[0] = '\0';
     singleTopicValue[0] = '\0';
+    rollupLastValue[0] = '\0';
   }
+
+  initRollup(); //Setup the rollup counters for single status mode
   
   //Setup Ledstrip
   strip.begin();
@@ -246,6 +273,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
   //Serial.print("] ");
 
   int LedId = 0;
+  int oldState = 0;
 
   //you should subscribe to topics like topic/# or topic/subtopic/#
   //This will result in topics like: topic/subtopic/0, topic/subtopic/1 where the number corresponds with the LED
@@ -265,6 +293,8 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
   //Serial.print("Token: ");
   //Serial.println(LedId);
 
+  oldState = ledStateArr[LedId]; //remember the current state to update the rollup counters
+
   payload[length] = '\0';
   
   //Print payload to Serial for debugging
@@ -330,6 +360,9 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
     else if(strcmp((char*)payload,"off") == 0){
           ledStateArr[LedId] = 0; 
   }
+
+  if(ledStateArr[LedId] != oldState) //Only a state transition changes the rollup
+    updateRollup(LedId, oldState, ledStateArr[LedId]);
 }
 //**************** END OF MQTT CALLBACK FUNCTION *********************************
 
@@ -460,45 +493,48 @@ void loop() {
 if(singleStatusParam.isChecked()){ //true means we want to only show one status in total on all leds
   int x = atoi(singleTopicValue); 
   Serial.println(x);
-  if(ledStateArr[x] == 1) //GREEN
+  int singleState = ledStateArr[x];
+  if(rollupEnabled)
+    singleState = rollupState; //worst status of the whole rollup range
+  if(singleState == 1) //GREEN
       colorWipe(strip.Color(0, 255, 0), 100); // Green
-  else if(ledStateArr[x] == 2) //GREEN BLINKING)
+  else if(singleState == 2) //GREEN BLINKING)
       theaterChase(strip.Color(0,255, 0), 120); 
 
   //Check for 2nd topic
-  else if(ledStateArr[x] == 3) //RED
+  else if(singleState == 3) //RED
     colorWipe(strip.Color(255, 0, 0), 100); // Red
-  else if(ledStateArr[x] == 4) //RED BLINKING)
+  else if(singleState == 4) //RED BLINKING)
       theaterChase(strip.Color(255,0, 0), 120); 
 
     
-  else if(ledStateArr[x] == 5) //YELLOW
+  else if(singleState == 5) //YELLOW
     colorWipe(strip.Color(128, 128, 0), 100); // Red
-  else if(ledStateArr[x] == 6) //YELLOW BLINKING)
+  else if(singleState == 6) //YELLOW BLINKING)
     theaterChase(strip.Color(128,128, 0), 120); 
 
   
   //Check for 4nd topic
-  else if(ledStateArr[x] == 7) //PURPLE
+  else if(singleState == 7) //PURPLE
     colorWipe(strip.Color(128, 0, 128), 100); // Purple
-  else if(ledStateArr[x] == 8) //PURPLE BLINKING)
+  else if(singleState == 8) //PURPLE BLINKING)
       theaterChase(strip.Color(128,0, 128), 120); 
 
   //BLUE SINGLE STATUS
-  else if(ledStateArr[x] == 9) //BLUE
+  else if(singleState == 9) //BLUE
     colorWipe(strip.Color(0, 0, 255), 100); // Blue
-  else if(ledStateArr[x] == 10) //BLUE BLINKING)
+  else if(singleState == 10) //BLUE BLINKING)
     theaterChase(strip.Color(0,0, 255), 120); // Orange blink
 
   //ORANGE SINGLE STATUS  
-  else if(ledStateArr[x] == 11) //ORANGE
+  else if(singleState == 11) //ORANGE
           colorWipe(strip.Color(255, 128, 0), 100); 
-  else if(ledStateArr[x] == 12) //ORANGE Blink
+  else if(singleState == 12) //ORANGE Blink
           theaterChase(strip.Color(255,128, 0), 120); 
   //WHITE SINGLE STATUS  
-  else if(ledStateArr[x] == 13) //WHITE
+  else if(singleState == 13) //WHITE
           colorWipe(strip.Color(200, 200, 200), 100); 
-  else if(ledStateArr[x] == 14) //WHITE Blink
+  else if(singleState == 14) //WHITE Blink
           theaterChase(strip.Color(200, 200, 200), 120); 
 
 }
@@ -583,6 +619,15 @@ void handleRoot()
   s += "<div>SingleStatus: ";
   s += singleStatusValue;
   s += "</div>";
+  s += "<div>Rollup Topics: ";
+  if(rollupEnabled){
+    s += rollupFirst;
+    s += " - ";
+    s += rollupLast;
+  }
+  else
+    s += "off";
+  s += "</div>";
   s += "<button type='button' onclick=\"location.href='';\" >Refresh</button>";
   s += "<div>Go to <a href='config'>configure page</a> to change values.</div>";
   s +="<div><small>MQTT NeoPixel Status Multiple - Version: ";
@@ -625,6 +670,47 @@ bool formValidator(iotwebconf::WebRequestWrapper* webRequestWrapper)
 }
 
 
+/*
+ Setup the rollup range and counters.
+ The range runs from Single Topic # up to Rollup Last Topic # and is limited to the existing leds,
+ since other topics end up in ledStateArr[0]. All topics in the range start as 'off' (0).
+*/
+void initRollup(){
+  rollupFirst = atoi(singleTopicValue);
+  rollupLast = atoi(rollupLastValue);
+  if(rollupFirst < 1)
+    rollupFirst = 1;
+  if(rollupLast > NUMBEROFLEDS)
+    rollupLast = NUMBEROFLEDS;
+  rollupEnabled = (rollupLast > rollupFirst);
+
+  for(int state = 0; state < NUMBEROFSTATES; state++)
+    rollupCount[state] = 0;
+  for(int x = rollupFirst; x <= rollupLast; x++)
+    rollupCount[ledStateArr[x]]++;
+  rollupState = 0;
+}
+
+/*
+ Move one topic from its old state counter to its new state counter and determine
+ the worst state in the rollup range by walking the fixed severityOrder list.
+*/
+void updateRollup(int ledId, int oldState, int newState){
+  if(!rollupEnabled || ledId < rollupFirst || ledId > rollupLast)
+    return;
+
+  rollupCount[oldState]--;
+  rollupCount[newState]++;
+
+  for(int i = 0; i < NUMBEROFSTATES; i++){
+    if(rollupCount[severityOrder[i]] > 0){
+      rollupState = severityOrder[i];
+      return;
+    }
+  }
+}
+
+
 /*
  Handle led_offset
  Set all leds to blue, next make the original first led Red and then set the 